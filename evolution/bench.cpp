@@ -0,0 +1,319 @@
+#include "evolution.hpp"
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+/***
+`evolution-bench` mierzy przepustowość algorytmu dla zestawów policy używanych
+w `doubleEvolution`, `vectorDoubleEvolution`, `intEvolution` i `vectorIntEvolution`
+(także z mutacją wykonywaną razem z krzyżowaniem, `fusedVectorIntEvolution`,
+a dla rzadkiej mutacji bezwzględnej osobno i razem z krzyżowaniem,
+`sparseMutationEvolution` i `fusedSparseMutationEvolution`, ta sama kombinacja
+w układzie SoA, `soaSparseMutationEvolution`, i oba układy z zatrzymaniem
+po średniej populacji, `averageStopEvolution` i `soaAverageStopEvolution`,
+oraz z genami float i BFloat16, `vectorFloatEvolution` i `vectorBFloat16Evolution`),
+dla rozmiarów populacji 1e2-1e7, wymiarów genomu 1-4096 oraz liczby wątków
+(tylko dla selekcji, które można wykonywać współbieżnie). Wynik w formacie JSON
+trafia na standardowe wyjście, postęp na standardowe wyjście błędów.
+
+  ./evolution-bench --max-population=1000000 --max-threads=8 > bench.json
+
+Dostępne opcje: --max-population, --max-dimension, --max-threads, --min-seconds
+(minimalny czas pomiaru jednej konfiguracji), --max-generation-seconds
+(konfiguracje, których przewidywany czas generacji jest dłuższy, są pomijane)
+oraz --memory-mib (limit pamięci obu buforów populacji).
+ */
+
+/* #region Combinations */
+template <typename TEntity>
+using DoubleEvolution = EvolutionaryAlgorithm<TEntity, RandomInitiationPolicy<TEntity, 0., 2137.>,
+                                              PercentageMutationPolicy<TEntity, 0.1, 10.>,
+                                              AverageCrossoverPolicy<TEntity, 0.3>, RandomSelectionPolicy<TEntity>,
+                                              MaxGenStopConditionPolicy<TEntity, 10>>;
+
+template <typename TEntity>
+using VectorDoubleEvolution =
+    EvolutionaryAlgorithm<TEntity, LinSpaceInitiationPolicy<TEntity, 0., 2137.>, AbsoluteMutationPolicy<TEntity, 0.1, 10.>,
+                          RandomCrossoverPolicy<TEntity>,
+                          TargetSelectionPolicy<TEntity, 0.3, 0.001, AbsoluteValueComparator<TEntity>>,
+                          StableAvgStopConditionPolicy<TEntity, 10.>>;
+
+template <typename TEntity>
+using IntEvolution =
+    EvolutionaryAlgorithm<TEntity, RandomInitiationPolicy<TEntity, 0, 2137>, AbsoluteMutationPolicy<TEntity, 0.1, 10>,
+                          AverageCrossoverPolicy<TEntity, 0.3>, UniqueRandomSelectionPolicy<TEntity>,
+                          StableAvgStopConditionPolicy<TEntity, 10>>;
+
+template <typename TEntity>
+using VectorIntEvolution =
+    EvolutionaryAlgorithm<TEntity, RandomInitiationPolicy<TEntity, 0, 2137>, PercentageMutationPolicy<TEntity, 0.1, 10>,
+                          RandomCrossoverPolicy<TEntity>, UniqueRandomSelectionPolicy<TEntity>,
+                          MaxGenStopConditionPolicy<TEntity, 10>>;
+
+// vectorDoubleEvolution with compact genes (float, BFloat16): the same population in a half or a quarter of the bytes.
+template <typename TEntity>
+using CompactVectorEvolution =
+    EvolutionaryAlgorithm<TEntity, LinSpaceInitiationPolicy<TEntity, NumeralType_t<TEntity>{0}, NumeralType_t<TEntity>{2137}>,
+                          AbsoluteMutationPolicy<TEntity, 0.1, NumeralType_t<TEntity>{10}>, RandomCrossoverPolicy<TEntity>,
+                          TargetSelectionPolicy<TEntity, 0.3, 0.001, AbsoluteValueComparator<TEntity>>,
+                          StableAvgStopConditionPolicy<TEntity, NumeralType_t<TEntity>{10}>>;
+
+// vectorIntEvolution with the fused kernel: each child is mutated right after crossover.
+template <typename TEntity>
+using FusedVectorIntEvolution =
+    EvolutionaryAlgorithm<TEntity, RandomInitiationPolicy<TEntity, 0, 2137>,
+                          FusedMutation<PercentageMutationPolicy<TEntity, 0.1, 10>>, RandomCrossoverPolicy<TEntity>,
+                          UniqueRandomSelectionPolicy<TEntity>, MaxGenStopConditionPolicy<TEntity, 10>>;
+
+// One child in twenty mutates, so the separate mutation pass barely reads the new population and fusing it into the
+// breeding loop has little to save.
+template <typename TEntity>
+using SparseMutationEvolution =
+    EvolutionaryAlgorithm<TEntity, RandomInitiationPolicy<TEntity, 0., 2137.>, AbsoluteMutationPolicy<TEntity, 0.05, 10.>,
+                          RandomCrossoverPolicy<TEntity>, RandomSelectionPolicy<TEntity>,
+                          MaxGenStopConditionPolicy<TEntity, 10>>;
+
+template <typename TEntity>
+using FusedSparseMutationEvolution =
+    EvolutionaryAlgorithm<TEntity, RandomInitiationPolicy<TEntity, 0., 2137.>,
+                          FusedMutation<AbsoluteMutationPolicy<TEntity, 0.05, 10.>>, RandomCrossoverPolicy<TEntity>,
+                          RandomSelectionPolicy<TEntity>, MaxGenStopConditionPolicy<TEntity, 10>>;
+
+// sparseMutationEvolution in struct-of-arrays storage: crossover reads every parent gene from another column, which
+// stops paying off once genomes grow to a few hundred genes.
+template <typename TEntity>
+using SoASparseMutationEvolution =
+    EvolutionaryAlgorithm<TEntity, RandomInitiationPolicy<TEntity, 0., 2137.>, AbsoluteMutationPolicy<TEntity, 0.05, 10.>,
+                          RandomCrossoverPolicy<TEntity>, RandomSelectionPolicy<TEntity>,
+                          MaxGenStopConditionPolicy<TEntity, 10>, DefaultGenerator, StructOfArrays>;
+
+// sparseMutationEvolution stopped by the population average, so every generation is also summarised gene by gene,
+// which struct-of-arrays storage does one contiguous column at a time.
+template <typename TEntity>
+using AverageStopEvolution =
+    EvolutionaryAlgorithm<TEntity, RandomInitiationPolicy<TEntity, 0., 2137.>, AbsoluteMutationPolicy<TEntity, 0.05, 10.>,
+                          RandomCrossoverPolicy<TEntity>, RandomSelectionPolicy<TEntity>,
+                          StableAvgStopConditionPolicy<TEntity, 10.>>;
+
+template <typename TEntity>
+using SoAAverageStopEvolution =
+    EvolutionaryAlgorithm<TEntity, RandomInitiationPolicy<TEntity, 0., 2137.>, AbsoluteMutationPolicy<TEntity, 0.05, 10.>,
+                          RandomCrossoverPolicy<TEntity>, RandomSelectionPolicy<TEntity>,
+                          StableAvgStopConditionPolicy<TEntity, 10.>, DefaultGenerator, StructOfArrays>;
+/* #endregion */
+
+/* #region Measurement */
+struct BenchOptions {
+  std::size_t maxPopulation = 10'000'000;
+  std::size_t maxDimension = 4096;
+  std::size_t maxThreads = std::max(std::thread::hardware_concurrency(), 1u);
+  double minSeconds = 0.2;
+  double maxGenerationSeconds = 5.;
+  std::size_t memoryBytes = std::size_t{1} << 30;
+};
+
+struct Measurement {
+  std::size_t generations = 0;
+  double seconds = 0;
+  std::size_t allocations = 0;
+};
+
+template <typename TAlgorithm>
+concept ParallelAlgorithm = requires(TAlgorithm &algorithm, ThreadPool &pool) {
+  { algorithm.advance(pool) } -> std::same_as<bool>;
+};
+
+// Runs fresh instances until minSeconds of generation time have been collected. Only generations the algorithm
+// actually completed are timed; construction and the final, stopping call are left out. An instance that stops
+// before its first generation ends the measurement, which then reports no generations.
+template <typename TAlgorithm>
+Measurement measure(std::size_t populationSize, ThreadPool *pool, const BenchOptions &options) {
+  Measurement measurement;
+  std::uint64_t seed = 2137;
+  while (measurement.seconds < options.minSeconds) {
+    TAlgorithm algorithm(populationSize, seed++);
+    const std::size_t generationsBefore = measurement.generations;
+    while (measurement.seconds < options.minSeconds) {
+      const std::size_t allocationsBefore = allocationCount.load(std::memory_order_relaxed);
+      const auto start = std::chrono::steady_clock::now();
+      bool advanced = false;
+      if constexpr (ParallelAlgorithm<TAlgorithm>) {
+        advanced = pool != nullptr ? algorithm.advance(*pool) : algorithm.advance();
+      } else {
+        advanced = algorithm.advance();
+      }
+      const auto end = std::chrono::steady_clock::now();
+      if (!advanced) {
+        break;
+      }
+      measurement.seconds += std::chrono::duration<double>(end - start).count();
+      measurement.allocations += allocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+      ++measurement.generations;
+    }
+    if (measurement.generations == generationsBefore) {
+      break;
+    }
+  }
+  return measurement;
+}
+/* #endregion */
+
+/* #region Report */
+class JsonReport {
+public:
+  JsonReport() {
+    std::cout.precision(6);
+    std::cout << "{\n  \"benchmark\": \"evolution-bench\",\n  \"hardwareConcurrency\": "
+              << std::thread::hardware_concurrency() << ",\n  \"results\": [";
+  }
+
+  ~JsonReport() { std::cout << "\n  ]\n}\n"; }
+
+  void measured(std::string_view combination, std::size_t dimension, std::size_t populationSize, std::size_t threads,
+                const Measurement &measurement) {
+    begin(combination, dimension, populationSize, threads);
+    const auto generations = static_cast<double>(measurement.generations);
+    std::cout << ", \"generations\": " << measurement.generations << ", \"seconds\": " << measurement.seconds
+              << ", \"generationsPerSecond\": " << generations / measurement.seconds
+              << ", \"nsPerOffspring\": " << measurement.seconds * 1e9 / (generations * static_cast<double>(populationSize))
+              << ", \"allocationsPerGeneration\": " << static_cast<double>(measurement.allocations) / generations << "}";
+  }
+
+  void skipped(std::string_view combination, std::size_t dimension, std::size_t populationSize, std::size_t threads,
+               std::string_view reason) {
+    begin(combination, dimension, populationSize, threads);
+    std::cout << ", \"skipped\": \"" << reason << "\"}";
+  }
+
+private:
+  bool first_ = true;
+
+  void begin(std::string_view combination, std::size_t dimension, std::size_t populationSize, std::size_t threads) {
+    std::cout << (first_ ? "\n" : ",\n") << "    {\"combination\": \"" << combination << "\", \"dimension\": " << dimension
+              << ", \"populationSize\": " << populationSize << ", \"threads\": " << threads;
+    first_ = false;
+  }
+};
+/* #endregion */
+
+/* #region Sweep */
+// Sweeps population sizes upwards for one combination, entity type and thread count. The time of the next size is
+// extrapolated from the growth between the last two measurements, so super-linear selections stop early.
+template <typename TAlgorithm>
+void sweepPopulation(JsonReport &report, std::string_view combination, std::size_t threads, const BenchOptions &options) {
+  using Entity = typename TAlgorithm::Entity;
+  const std::size_t dimension = EntityDimension_v<Entity>;
+  std::unique_ptr<ThreadPool> pool = threads > 1 ? std::make_unique<ThreadPool>(threads) : nullptr;
+
+  double lastSize = 0;
+  double lastSecondsPerGeneration = 0;
+  double exponent = 1;
+  for (std::size_t populationSize = 100; populationSize <= options.maxPopulation; populationSize *= 10) {
+    if (2 * populationSize * sizeof(Entity) > options.memoryBytes) {
+      report.skipped(combination, dimension, populationSize, threads, "memory");
+      continue;
+    }
+    const double predicted = lastSecondsPerGeneration * std::pow(static_cast<double>(populationSize) / lastSize, exponent);
+    if (lastSize > 0 && predicted > options.maxGenerationSeconds) {
+      report.skipped(combination, dimension, populationSize, threads, "time");
+      continue;
+    }
+
+    std::cerr << combination << " dimension " << dimension << " population " << populationSize << " threads " << threads
+              << "\n";
+    const Measurement measurement = measure<TAlgorithm>(populationSize, pool.get(), options);
+    if (measurement.generations == 0) {
+      report.skipped(combination, dimension, populationSize, threads, "stopped");
+      continue;
+    }
+    report.measured(combination, dimension, populationSize, threads, measurement);
+
+    const double secondsPerGeneration = measurement.seconds / static_cast<double>(measurement.generations);
+    if (lastSize > 0) {
+      exponent = std::max(1., std::log(secondsPerGeneration / lastSecondsPerGeneration) /
+                                  std::log(static_cast<double>(populationSize) / lastSize));
+    }
+    lastSize = static_cast<double>(populationSize);
+    lastSecondsPerGeneration = secondsPerGeneration;
+  }
+}
+
+template <typename TAlgorithm>
+void sweepThreads(JsonReport &report, std::string_view combination, const BenchOptions &options) {
+  if (EntityDimension_v<typename TAlgorithm::Entity> > options.maxDimension) {
+    return;
+  }
+  sweepPopulation<TAlgorithm>(report, combination, 1, options);
+  if constexpr (ParallelAlgorithm<TAlgorithm>) {
+    for (std::size_t threads = 2; threads < 2 * options.maxThreads; threads *= 2) {
+      sweepPopulation<TAlgorithm>(report, combination, std::min(threads, options.maxThreads), options);
+    }
+  }
+}
+
+template <template <typename> typename TAlgorithm, typename TNumeral, std::size_t... TDIMENSIONS>
+void sweepDimensions(JsonReport &report, std::string_view combination, const BenchOptions &options) {
+  (sweepThreads<TAlgorithm<std::array<TNumeral, TDIMENSIONS>>>(report, combination, options), ...);
+}
+/* #endregion */
+
+BenchOptions parseOptions(int argc, char **argv) {
+  BenchOptions options;
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view argument = argv[i];
+    const auto separator = argument.find('=');
+    const std::string_view name = argument.substr(0, separator);
+    const std::string value{separator == std::string_view::npos ? "" : argument.substr(separator + 1)};
+    if (name == "--max-population") {
+      options.maxPopulation = std::stoull(value);
+    } else if (name == "--max-dimension") {
+      options.maxDimension = std::stoull(value);
+    } else if (name == "--max-threads") {
+      options.maxThreads = std::max<std::size_t>(std::stoull(value), 1);
+    } else if (name == "--min-seconds") {
+      options.minSeconds = std::stod(value);
+    } else if (name == "--max-generation-seconds") {
+      options.maxGenerationSeconds = std::stod(value);
+    } else if (name == "--memory-mib") {
+      options.memoryBytes = std::stoull(value) << 20;
+    } else {
+      std::cerr << "Unknown option: " << argument << "\n";
+      std::exit(EXIT_FAILURE);
+    }
+  }
+  return options;
+}
+
+int main(int argc, char **argv) {
+  const BenchOptions options = parseOptions(argc, argv);
+  JsonReport report;
+
+  sweepThreads<DoubleEvolution<double>>(report, "doubleEvolution", options);
+  sweepDimensions<VectorDoubleEvolution, double, 1, 4, 16, 64, 256, 1024, 4096>(report, "vectorDoubleEvolution", options);
+  sweepDimensions<CompactVectorEvolution, float, 1, 4, 16, 64, 256, 1024, 4096>(report, "vectorFloatEvolution", options);
+  sweepDimensions<CompactVectorEvolution, BFloat16, 1, 4, 16, 64, 256, 1024, 4096>(report, "vectorBFloat16Evolution",
+                                                                                   options);
+  sweepThreads<IntEvolution<int>>(report, "intEvolution", options);
+  sweepDimensions<VectorIntEvolution, int, 1, 4, 16, 64, 256, 1024, 4096>(report, "vectorIntEvolution", options);
+  sweepDimensions<FusedVectorIntEvolution, int, 1, 4, 16, 64, 256, 1024, 4096>(report, "fusedVectorIntEvolution", options);
+  sweepDimensions<SparseMutationEvolution, double, 1, 4, 16, 64, 256, 1024, 4096>(report, "sparseMutationEvolution",
+                                                                                 options);
+  sweepDimensions<FusedSparseMutationEvolution, double, 1, 4, 16, 64, 256, 1024, 4096>(
+      report, "fusedSparseMutationEvolution", options);
+  sweepDimensions<SoASparseMutationEvolution, double, 1, 4, 16, 64, 256, 1024, 4096>(report, "soaSparseMutationEvolution",
+                                                                                    options);
+  sweepDimensions<AverageStopEvolution, double, 1, 4, 16, 64, 256, 1024, 4096>(report, "averageStopEvolution", options);
+  sweepDimensions<SoAAverageStopEvolution, double, 1, 4, 16, 64, 256, 1024, 4096>(report, "soaAverageStopEvolution",
+                                                                                 options);
+
+  return 0;
+}
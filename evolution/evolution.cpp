@@ -1,579 +1,808 @@
-#include <algorithm>
-#include <cassert>
-#include <concepts>
-#include <ctime>
+#include "evolution.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
-#include <random>
-#include <type_traits>
-#include <vector>
-
-/***
- * Przygotować prosty algorytm ewolucyjny dla populacji liczb, wektorów lub tablic.
- * Klasy wytycznych mają kontrolować działanie algorytmu.
- * Jako parametry szablonu algorytmu ewolucyjnego mogą zostać podane typy, szablony lub instancje policy,
- * według Państwa wyboru.
- * Celem jest, poza funkcjonalnym algorytmem, wygodna konfiguracja algorytmu, i na to będę zwracał szczególną uwagę!
- * Mogą Państwo dowolnie modyfikować kod, o ile uznają Państwo, że to poprawi użytkowość,
- * przy czym sama zasada działania algorytmu ma się nie zmienić.
- * Istotne zmiany API powinny zostać opisane i podane przykłady użycia.
- *
- * Klasy wytycznych dla inicjalizacji populacji:
- *  - RandomInitiationPolicy<Type, MIN, MAX>: wypełnia populację losowymi osobnikami z zakresu (MIN, MAX)
- *  - LinSpaceInitiationPolicy<Type, MIN, MAX>: wypełnia populację osobnikami z zakresu (MIN, MAX),
- *    tak aby osobniki były liniowo rozłożone pomiędzy MIN i MAX.
- * Klasy wytycznych dla mutacji populacji:
- *  - PercentageMutationPolicy<Type, CHANCE, INTENSITY>: mutuje z prawdopodobieństwem CHANCE
- *    i mnoży wartość osobnika przez liczbę z zakresu (1 - INTENSITY/100, 1 + INTENSITY/100).
- *  - AbsoluteMutationPolicy<Type, CHANCE, INTENSITY>: mutuje z prawdopodobieństwem CHANCE
- *    i dodaje do wartości osobnika losową wartość z zakresu (-INTENSITY, INTENSITY).
- * Klasy wytycznych dla krzyżowania populacji:
- *  - AverageCrossoverPolicy<Type, WEIGHT>: tworzy nowego osobnika jako średnią ważoną rodziców (wagi to WEIGHT i 1 - WEIGHT).
- *    W przypadku wektorów wagi powinny być wektorami o wartościach z zakresu (0, 1) i tej samej długości co Type.
- *  - RandomCrossoverPolicy<Type>: To samo co wyżej, ale waga jest losowa.
- * Klasy wytycznych dla selekcji:
- *  - RandomSelectionPolicy<Type>: wybiera dwoje rodziców w sposób losowy.
- *  - UniqueRandomSelectionPolicy<Type>: wybiera dwoje rodziców w sposób losowy, ale bez powtórzeń (każda para jest wybierana
- * dwukrotnie).
- *  - TargetSelectionPolicy<Type, FIRST, LAST>: wybiera dwoje rodziców w sposób losowy,
- *    ale w taki sposób, że cała populacja jest ułożona w rankingu od najlepszego do najgorszego.
- *    Osobnik pierwszy w rankingu ma mieć FIRST% szans, a ostatni LAST%. Reszta ma szanse malejące w sposób liniowy.
- * Klasy wytycznych dla zakończenia algorytmu:
- *  - MaxGenStopConditionPolicy<Type, PARAM>: przerywa algorytm po PARAM generacjach.
- *  - StableAvgStopConditionPolicy<Type, PARAM>: przerywa algorytm, jeżeli od poprzedniego sprawdzenia warunku średnia generacji
- *    nie zmieniła się o więcej niż PARAM.
- */
-
-/***
-Zdecydowałem zamienić predefiniowane struktury na koncepty. W moim zdaniu,
-w kontekście tego zadania klasy abstrakcyjne mijają się z celem.
-
-Zdecydowałem wspierać tylko wartości numeryczne oraz tablice stałej wielkości
-(std::array) jako typy osobników. Wektory zmiennej długości w takim przypadku
-nadmiernie komplikują kod i uniemożliwiają wygodne korzystanie z szablonów.
-
-StopConditionPolicy zostało polem klasy, ze względu na to, że
-`StableAvgStopConditionPolicy` zawiera stan.
- */
-
-/* #region NumeralType */
-template <typename TEntity, typename = void> struct NumeralType;
-
-template <typename TEntity> struct NumeralType<TEntity, std::enable_if_t<std::is_arithmetic_v<TEntity>>> {
-  using Type = TEntity;
-};
+#include <limits>
+#include <span>
+#include <string_view>
 
-template <typename TEntity>
-struct NumeralType<TEntity,
-                   std::enable_if_t<std::is_array_v<TEntity> && std::is_arithmetic_v<std::remove_all_extents_t<TEntity>>>> {
-  using Type = std::remove_all_extents_t<TEntity>;
-};
+/* #region TestMethods */
+void doubleEvolution() {
+  constexpr auto minInit = 0.;
+  constexpr auto maxInit = 2137.;
+  constexpr auto mutationChance = 0.1;
+  constexpr auto mutationIntensity = 10.;
+  constexpr auto crossoverWeight = 0.3;
+  constexpr auto generationLimit = 10;
+  constexpr auto populationSize = 36;
 
-template <typename TEntity> struct NumeralType<TEntity, std::void_t<typename TEntity::value_type>> {
-  using Type = typename TEntity::value_type;
-};
+  using Entity = double;
 
-template <typename TEntity> using NumeralType_t = typename NumeralType<TEntity>::Type;
+  EvolutionaryAlgorithm<Entity, RandomInitiationPolicy<Entity, minInit, maxInit>,
+                        PercentageMutationPolicy<Entity, mutationChance, mutationIntensity>,
+                        AverageCrossoverPolicy<Entity, crossoverWeight>, RandomSelectionPolicy<Entity>,
+                        MaxGenStopConditionPolicy<Entity, generationLimit>>
+      algorithm(populationSize);
+  algorithm.run();
+}
 
-static_assert(std::is_same_v<double, NumeralType_t<double>>);
-static_assert(std::is_same_v<double, NumeralType_t<std::vector<double>>>);
-static_assert(std::is_same_v<double, NumeralType_t<std::array<double, 0>>>);
-/* #endregion */
+void vectorDoubleEvolution() {
+  constexpr auto dimension = 4;
+  constexpr auto minInit = 0.;
+  constexpr auto maxInit = 2137.;
+  constexpr auto mutationChance = 0.1;
+  constexpr auto mutationIntensity = 10.;
+  constexpr auto targetLast = 0.001;
+  constexpr auto targetFirst = 0.3;
+  constexpr auto generationLimit = 10.;
+  constexpr auto populationSize = 36;
 
-/* #region Distribution */
-template <typename TEntity> struct UniformDistribution {
-  using Numeral = NumeralType_t<TEntity>;
-  using Distribution = std::conditional_t<std::is_floating_point_v<Numeral>, std::uniform_real_distribution<Numeral>,
-                                          std::uniform_int_distribution<Numeral>>;
-  using Generator = std::mt19937;
-};
-/* #endregion */
+  using Entity = std::array<double, dimension>;
 
-/* #region PrintEntity */
-template <typename TEntity, typename = void> struct PrintEntity;
+  EvolutionaryAlgorithm<Entity, LinSpaceInitiationPolicy<Entity, minInit, maxInit>,
+                        AbsoluteMutationPolicy<Entity, mutationChance, mutationIntensity>, RandomCrossoverPolicy<Entity>,
+                        TargetSelectionPolicy<Entity, targetFirst, targetLast, AbsoluteValueComparator<Entity>>,
+                        StableAvgStopConditionPolicy<Entity, generationLimit>>
+      algorithm(populationSize);
+  algorithm.run();
+}
 
-template <typename TEntity> struct PrintEntity<TEntity, std::enable_if_t<std::is_arithmetic_v<TEntity>>> {
-  static void print(const TEntity &entity) { std::cout << entity << " "; }
-};
+void intEvolution() {
+  constexpr auto minInit = 0;
+  constexpr auto maxInit = 2137;
+  constexpr auto mutationChance = 0.1;
+  constexpr auto mutationIntensity = 10;
+  constexpr auto crossoverWeight = 0.3;
+  constexpr auto generationLimit = 10;
+  constexpr auto populationSize = 36;
 
-template <typename TEntity> struct PrintEntity<TEntity, std::enable_if_t<!std::is_arithmetic_v<TEntity>>> {
-  static void print(const TEntity &entity) {
-    for (const auto &element : entity) {
-      std::cout << element << " ";
-    }
-    std::cout << "\n";
-  }
-};
-/* #endregion */
+  using Entity = int;
 
-/* #region InitiationPolicy */
-template <typename TEntity, typename = void> struct InitializeEntity;
+  EvolutionaryAlgorithm<Entity, RandomInitiationPolicy<Entity, minInit, maxInit>,
+                        AbsoluteMutationPolicy<Entity, mutationChance, mutationIntensity>,
+                        AverageCrossoverPolicy<Entity, crossoverWeight>, UniqueRandomSelectionPolicy<Entity>,
+                        StableAvgStopConditionPolicy<Entity, generationLimit>>
+      algorithm(populationSize);
+  algorithm.run();
+}
 
-template <typename TEntity> struct InitializeEntity<TEntity, std::enable_if_t<std::is_arithmetic_v<TEntity>>> {
-  inline static void initRandom(TEntity &individual, typename UniformDistribution<TEntity>::Generator &generator,
-                                typename UniformDistribution<TEntity>::Distribution &distribution) {
-    individual = distribution(generator);
-  }
+void vectorIntEvolution() {
+  constexpr auto dimension = 4;
+  constexpr auto minInit = 0;
+  constexpr auto maxInit = 2137;
+  constexpr auto mutationChance = 0.1;
+  constexpr auto mutationIntensity = 10;
+  constexpr auto crossoverWeight = 0.3;
+  constexpr auto generationLimit = 10;
+  constexpr auto populationSize = 36;
 
-  inline static void initValue(TEntity &individual, NumeralType_t<TEntity> value) { individual = value; }
-};
+  using Entity = std::array<int, dimension>;
 
-template <typename TEntity> struct InitializeEntity<TEntity, std::enable_if_t<!std::is_arithmetic_v<TEntity>>> {
-  inline static void initRandom(TEntity &individual,
-                                typename UniformDistribution<typename TEntity::value_type>::Generator &generator,
-                                typename UniformDistribution<typename TEntity::value_type>::Distribution &distribution) {
-    for (auto &element : individual) {
-      element = distribution(generator);
-    }
-  }
+  EvolutionaryAlgorithm<Entity, RandomInitiationPolicy<Entity, minInit, maxInit>,
+                        PercentageMutationPolicy<Entity, mutationChance, mutationIntensity>, RandomCrossoverPolicy<Entity>,
+                        UniqueRandomSelectionPolicy<Entity>, MaxGenStopConditionPolicy<Entity, generationLimit>>
+      algorithm(populationSize);
+  algorithm.run();
+}
 
-  inline static void initValue(TEntity &individual, const typename TEntity::value_type &value) {
-    for (auto &element : individual) {
-      element = value;
-    }
-  }
-};
+/* #endregion */
 
-template <typename TInitiationPolicy, typename TEntity>
-concept InitiationPolicy = requires(std::vector<TEntity> &population, std::size_t populationSize) {
-  { TInitiationPolicy::init(population, populationSize) } -> std::same_as<void>;
-};
+void parallelVectorDoubleEvolution() {
+  constexpr auto dimension = 4;
+  constexpr auto minInit = 0.;
+  constexpr auto maxInit = 2137.;
+  constexpr auto mutationChance = 0.1;
+  constexpr auto mutationIntensity = 10.;
+  constexpr auto targetLast = 0.001;
+  constexpr auto targetFirst = 0.3;
+  constexpr auto generationLimit = 10;
+  constexpr auto populationSize = 36;
+  constexpr auto threadCount = 4;
 
-template <typename TEntity, NumeralType_t<TEntity> TMIN, NumeralType_t<TEntity> TMAX> struct RandomInitiationPolicy {
-  static void init(std::vector<TEntity> &population, std::size_t populationSize) {
-    assert(populationSize > 1);
-    typename UniformDistribution<TEntity>::Generator generator{std::random_device{}()};
-    typename UniformDistribution<TEntity>::Distribution distribution{TMIN, TMAX};
-    population = std::vector<TEntity>(populationSize);
-    for (auto &individual : population) {
-      InitializeEntity<TEntity>::initRandom(individual, generator, distribution);
-    }
-  }
-};
+  using Entity = std::array<double, dimension>;
 
-template <typename TEntity, NumeralType_t<TEntity> TMIN, NumeralType_t<TEntity> TMAX> struct LinSpaceInitiationPolicy {
-  static void init(std::vector<TEntity> &population, std::size_t populationSize) {
-    assert(populationSize > 1);
-    const NumeralType_t<TEntity> step = (TMAX - TMIN) / (populationSize - 1);
-    population = std::vector<TEntity>(populationSize);
-    auto value = TMIN;
-    for (auto &individual : population) {
-      InitializeEntity<TEntity>::initValue(individual, value);
-      value += step;
-    }
-  }
-};
+  EvolutionaryAlgorithm<Entity, RandomInitiationPolicy<Entity, minInit, maxInit>,
+                        AbsoluteMutationPolicy<Entity, mutationChance, mutationIntensity>, RandomCrossoverPolicy<Entity>,
+                        RankSelectionPolicy<Entity, targetFirst, targetLast, AbsoluteValueComparator<Entity>>,
+                        MaxGenStopConditionPolicy<Entity, generationLimit>>
+      algorithm(populationSize);
+  algorithm.runParallel(threadCount);
+}
 
-constexpr double TEST_MIN = 0;
-constexpr double TEST_MAX = 10;
-static_assert(InitiationPolicy<RandomInitiationPolicy<double, TEST_MIN, TEST_MAX>, double>);
-static_assert(InitiationPolicy<LinSpaceInitiationPolicy<double, TEST_MIN, TEST_MAX>, double>);
+void seededEvolution() {
+  constexpr auto minInit = 0.;
+  constexpr auto maxInit = 2137.;
+  constexpr auto mutationChance = 0.1;
+  constexpr auto mutationIntensity = 10.;
+  constexpr auto generationLimit = 10;
+  constexpr auto populationSize = 36;
+  constexpr std::uint64_t seed = 2137;
 
-/* #endregion */
+  using Entity = double;
+  using Algorithm = EvolutionaryAlgorithm<Entity, RandomInitiationPolicy<Entity, minInit, maxInit>,
+                                          PercentageMutationPolicy<Entity, mutationChance, mutationIntensity>,
+                                          RandomCrossoverPolicy<Entity>, RandomSelectionPolicy<Entity>,
+                                          MaxGenStopConditionPolicy<Entity, generationLimit>, Pcg32>;
+
+  // Both runs print the same population.
+  Algorithm first(populationSize, seed);
+  first.run();
+  Algorithm replay(populationSize, first.seed());
+  replay.run();
+}
 
-/* #region MutationPolicy */
-template <typename TEntity, typename = void> struct MutateEntity;
+void allocationFreeEvolution() {
+  constexpr auto dimension = 4;
+  constexpr auto minInit = 0.;
+  constexpr auto maxInit = 2137.;
+  constexpr auto mutationChance = 0.1;
+  constexpr auto mutationIntensity = 10.;
+  constexpr auto targetLast = 0.001;
+  constexpr auto targetFirst = 0.3;
+  constexpr auto generationLimit = 100;
+  constexpr auto populationSize = 1000;
+  constexpr auto warmUpGenerations = 1;
+  constexpr auto measuredGenerations = 20;
 
-template <typename TEntity> struct MutateEntity<TEntity, std::enable_if_t<std::is_arithmetic_v<TEntity>>> {
-  static void mutatePercentage(TEntity &entity, typename UniformDistribution<TEntity>::Generator &generator,
-                               typename UniformDistribution<double>::Distribution &intensityDistribution) {
-    entity *= intensityDistribution(generator);
-  }
+  using Entity = std::array<double, dimension>;
 
-  static void mutateAbsolute(TEntity &entity, typename UniformDistribution<TEntity>::Generator &generator,
-                             typename UniformDistribution<double>::Distribution &intensityDistribution) {
-    entity += intensityDistribution(generator);
+  EvolutionaryAlgorithm<Entity, RandomInitiationPolicy<Entity, minInit, maxInit>,
+                        AbsoluteMutationPolicy<Entity, mutationChance, mutationIntensity>, RandomCrossoverPolicy<Entity>,
+                        RankSelectionPolicy<Entity, targetFirst, targetLast, AbsoluteValueComparator<Entity>>,
+                        MaxGenStopConditionPolicy<Entity, generationLimit>>
+      algorithm(populationSize);
+  for (int i = 0; i < warmUpGenerations; ++i) {
+    algorithm.step();
   }
-};
 
-template <typename TEntity> struct MutateEntity<TEntity, std::enable_if_t<!std::is_arithmetic_v<TEntity>>> {
-  static void mutatePercentage(TEntity &entity,
-                               typename UniformDistribution<typename TEntity::value_type>::Generator &generator,
-                               typename UniformDistribution<double>::Distribution &intensityDistribution) {
-    for (auto &element : entity) {
-      element *= intensityDistribution(generator);
-    }
+  const std::size_t allocationsBefore = allocationCount.load();
+  for (int i = 0; i < measuredGenerations; ++i) {
+    algorithm.step();
   }
+  const std::size_t steadyStateAllocations = allocationCount.load() - allocationsBefore;
 
-  static void mutateAbsolute(TEntity &entity, typename UniformDistribution<typename TEntity::value_type>::Generator &generator,
-                             typename UniformDistribution<double>::Distribution &intensityDistribution) {
-    for (auto &element : entity) {
-      element += intensityDistribution(generator);
-    }
-  }
-};
+  std::cout << "Heap allocations in " << measuredGenerations << " steady-state generations: " << steadyStateAllocations
+            << "\n";
+  assert(steadyStateAllocations == 0);
+}
 
-template <typename TMutationPolicy, typename TEntity>
-concept MutationPolicy = requires(std::vector<TEntity> &population) {
-  { TMutationPolicy::mutate(population) } -> std::same_as<void>;
-};
+void structOfArraysEvolution() {
+  constexpr auto dimension = 4;
+  constexpr auto minInit = 0.;
+  constexpr auto maxInit = 2137.;
+  constexpr auto mutationChance = 0.1;
+  constexpr auto mutationIntensity = 10.;
+  constexpr auto targetLast = 0.001;
+  constexpr auto targetFirst = 0.3;
+  constexpr auto generationLimit = 10.;
+  constexpr auto populationSize = 36;
 
-template <typename TEntity, double TCHANCE, NumeralType_t<TEntity> TINTENSITY> struct PercentageMutationPolicy {
-  static void mutate(std::vector<TEntity> &population) {
-    typename UniformDistribution<double>::Generator generator{std::random_device{}()};
-    typename UniformDistribution<double>::Distribution chanceDistribution{0, 1};
-    typename UniformDistribution<double>::Distribution intensityDistribution{1 - TINTENSITY / 100.0, 1 + TINTENSITY / 100.0};
-    for (TEntity &individual : population) {
-      if (chanceDistribution(generator) >= TCHANCE) {
-        MutateEntity<TEntity>::mutatePercentage(individual, generator, intensityDistribution);
-      }
-    }
-  }
-};
+  using Entity = std::array<double, dimension>;
 
-template <typename TEntity, double TCHANCE, NumeralType_t<TEntity> TINTENSITY> struct AbsoluteMutationPolicy {
-  static void mutate(std::vector<TEntity> &population) {
-    typename UniformDistribution<TEntity>::Generator generator{std::random_device{}()};
-    typename UniformDistribution<TEntity>::Distribution chanceDistribution{0, 1};
-    typename UniformDistribution<double>::Distribution intensityDistribution{-TINTENSITY, TINTENSITY};
-    for (TEntity &individual : population) {
-      if (chanceDistribution(generator) >= TCHANCE) {
-        MutateEntity<TEntity>::mutateAbsolute(individual, generator, intensityDistribution);
-      }
-    }
-  }
-};
+  EvolutionaryAlgorithm<Entity, LinSpaceInitiationPolicy<Entity, minInit, maxInit>,
+                        PercentageMutationPolicy<Entity, mutationChance, mutationIntensity>, RandomCrossoverPolicy<Entity>,
+                        RankSelectionPolicy<Entity, targetFirst, targetLast, AbsoluteValueComparator<Entity>>,
+                        StableAvgStopConditionPolicy<Entity, generationLimit>, DefaultGenerator, StructOfArrays>
+      algorithm(populationSize);
+  algorithm.run();
+}
 
-constexpr double TEST_CHANCE = 0.1;
-constexpr double TEST_INTENSITY = 10;
-static_assert(MutationPolicy<PercentageMutationPolicy<double, TEST_CHANCE, TEST_INTENSITY>, double>);
-static_assert(MutationPolicy<AbsoluteMutationPolicy<double, TEST_CHANCE, TEST_INTENSITY>, double>);
-/* #endregion */
+void batchMutationEvolution() {
+  constexpr auto dimension = 4;
+  constexpr auto minInit = 0;
+  constexpr auto maxInit = 2137;
+  constexpr auto mutationChance = 0.1;
+  constexpr auto mutationIntensity = 10;
+  constexpr auto crossoverWeight = 0.3;
+  constexpr auto generationLimit = 10;
+  constexpr auto populationSize = 36;
 
-/* #region CrossoverPolicy */
-template <typename TEntity, typename = void> struct CrossoverEntity;
+  using Entity = std::array<int, dimension>;
 
-template <typename TEntity> struct CrossoverEntity<TEntity, std::enable_if_t<std::is_arithmetic_v<TEntity>>> {
-  static inline TEntity crossover(const TEntity &parent1, const TEntity &parent2, double weight) {
-    return (parent1 * weight + parent2 * (1 - weight));
-  }
-};
+  EvolutionaryAlgorithm<Entity, RandomInitiationPolicy<Entity, minInit, maxInit>,
+                        BatchAbsoluteMutationPolicy<Entity, mutationChance, mutationIntensity>,
+                        AverageCrossoverPolicy<Entity, crossoverWeight>, RandomSelectionPolicy<Entity>,
+                        MaxGenStopConditionPolicy<Entity, generationLimit>>
+      algorithm(populationSize);
+  algorithm.run();
+}
 
-template <typename TEntity> struct CrossoverEntity<TEntity, std::enable_if_t<!std::is_arithmetic_v<TEntity>>> {
-  static inline TEntity crossover(const TEntity &parent1, const TEntity &parent2, double weight) {
-    TEntity offspring{};
-    for (std::size_t i = 0; i < parent1.size(); ++i) {
-      auto it1 = parent1.begin();
-      auto it2 = parent2.begin();
-      auto itOffspring = offspring.begin();
-      while (it1 != parent1.end() && it2 != parent2.end() && itOffspring != offspring.end()) {
-        *itOffspring = *it1 * weight + *it2 * (1 - weight);
-        ++it1;
-        ++it2;
-        ++itOffspring;
-      }
-    }
-    return offspring;
-  }
-};
+void geneMutationEvolution() {
+  constexpr auto dimension = 256;
+  constexpr auto minInit = 0.;
+  constexpr auto maxInit = 2137.;
+  constexpr auto geneMutationRate = 1e-4;
+  constexpr auto mutationIntensity = 10.;
+  constexpr auto generationLimit = 10;
+  constexpr auto populationSize = 36;
 
-template <typename TCrossoverPolicy, typename TEntity>
-concept CrossoverPolicy = requires(TEntity parent1, TEntity parent2) {
-  { TCrossoverPolicy::crossover(parent1, parent2) } -> std::same_as<TEntity>;
-};
+  using Entity = std::array<double, dimension>;
 
-template <typename TEntity, double TWEIGHT> struct AverageCrossoverPolicy {
-  static TEntity crossover(const TEntity &parent1, const TEntity &parent2) {
-    assert(TWEIGHT >= 0 && TWEIGHT <= 1);
-    return CrossoverEntity<TEntity>::crossover(parent1, parent2, TWEIGHT);
+  EvolutionaryAlgorithm<Entity, RandomInitiationPolicy<Entity, minInit, maxInit>,
+                        GeneAbsoluteMutationPolicy<Entity, geneMutationRate, mutationIntensity>, RandomCrossoverPolicy<Entity>,
+                        UniqueRandomSelectionPolicy<Entity>, MaxGenStopConditionPolicy<Entity, generationLimit>>
+      algorithm(populationSize);
+  for (int i = 0; i < generationLimit; ++i) {
+    algorithm.step();
   }
-};
+  std::cout << "Per-gene mutation ran " << algorithm.generation() << " generations.\n";
+}
 
-template <typename TEntity> struct RandomCrossoverPolicy {
-  static TEntity crossover(const TEntity &parent1, const TEntity &parent2) {
-    typename UniformDistribution<double>::Generator generator{std::random_device{}()};
-    typename UniformDistribution<double>::Distribution distribution{0, 1};
-    const double weight = distribution(generator);
-    return CrossoverEntity<TEntity>::crossover(parent1, parent2, weight);
-  }
-};
+void islandEvolution() {
+  constexpr auto dimension = 4;
+  constexpr auto minInit = 0.;
+  constexpr auto maxInit = 2137.;
+  constexpr auto mutationChance = 0.1;
+  constexpr auto mutationIntensity = 10.;
+  constexpr auto targetLast = 0.001;
+  constexpr auto targetFirst = 0.3;
+  constexpr auto generationLimit = 50;
+  constexpr auto populationSize = 36;
+  constexpr auto islandCount = 4;
+  constexpr auto migrationInterval = 5;
+  constexpr auto migrantCount = 2;
 
-constexpr double TEST_WEIGHT = 0.5;
-static_assert(CrossoverPolicy<AverageCrossoverPolicy<double, TEST_WEIGHT>, double>);
-static_assert(CrossoverPolicy<RandomCrossoverPolicy<double>, double>);
-/* #endregion */
+  using Entity = std::array<double, dimension>;
+  using Algorithm = EvolutionaryAlgorithm<Entity, RandomInitiationPolicy<Entity, minInit, maxInit>,
+                                          AbsoluteMutationPolicy<Entity, mutationChance, mutationIntensity>,
+                                          RandomCrossoverPolicy<Entity>,
+                                          RankSelectionPolicy<Entity, targetFirst, targetLast, AbsoluteValueComparator<Entity>>,
+                                          MaxGenStopConditionPolicy<Entity, generationLimit>>;
+
+  IslandModel<Algorithm, AbsoluteValueComparator<Entity>, RandomTopology> model(islandCount, populationSize,
+                                                                                migrationInterval, migrantCount);
+  model.run();
+}
 
-/* #region SelectionPolicy */
+void steadyStateEvolution() {
+  constexpr auto minInit = 0.;
+  constexpr auto maxInit = 2137.;
+  constexpr auto mutationChance = 0.1;
+  constexpr auto mutationIntensity = 10.;
+  constexpr auto generationLimit = 10;
+  constexpr auto populationSize = 36;
+  constexpr auto batchSize = 4;
 
-template <typename TComparator, typename TEntity>
-concept CompareEntities = requires(const TEntity &lhs, const TEntity &rhs) {
-  { TComparator::compare(lhs, rhs) } -> std::same_as<bool>;
-};
+  using Entity = double;
+
+  SteadyStateEvolutionaryAlgorithm<Entity, RandomInitiationPolicy<Entity, minInit, maxInit>,
+                                   PercentageMutationPolicy<Entity, mutationChance, mutationIntensity>,
+                                   RandomCrossoverPolicy<Entity>, UniqueRandomSelectionPolicy<Entity>,
+                                   MaxGenStopConditionPolicy<Entity, generationLimit>, AbsoluteValueComparator<Entity>>
+      algorithm(populationSize, batchSize);
+  algorithm.run();
+}
 
-template <typename TEntity, typename = void> struct AbsoluteValueComparator;
+void statisticsEvolution() {
+  constexpr auto minInit = 0.;
+  constexpr auto maxInit = 2137.;
+  constexpr auto mutationChance = 0.1;
+  constexpr auto mutationIntensity = 10.;
+  constexpr auto stagnationLimit = 5;
+  constexpr auto populationSize = 36;
 
-template <typename TEntity> struct AbsoluteValueComparator<TEntity, std::enable_if_t<std::is_arithmetic_v<TEntity>>> {
-  static bool compare(const TEntity &lhs, const TEntity &rhs) { return std::abs(lhs) > std::abs(rhs); }
-};
+  using Entity = std::array<double, 4>;
 
-template <typename TEntity> struct AbsoluteValueComparator<TEntity, std::enable_if_t<!std::is_arithmetic_v<TEntity>>> {
-  static bool compare(const TEntity &lhs, const TEntity &rhs) {
-    return std::abs(std::accumulate(std::begin(lhs), std::end(lhs), NumeralType_t<TEntity>{})) >
-           std::abs(std::accumulate(std::begin(rhs), std::end(rhs), NumeralType_t<TEntity>{}));
+  EvolutionaryAlgorithm<Entity, RandomInitiationPolicy<Entity, minInit, maxInit>,
+                        AbsoluteMutationPolicy<Entity, mutationChance, mutationIntensity>, RandomCrossoverPolicy<Entity>,
+                        UniqueRandomSelectionPolicy<Entity>,
+                        StagnationStopConditionPolicy<Entity, stagnationLimit, AbsoluteValueComparator<Entity>>>
+      algorithm(populationSize);
+  while (algorithm.advance()) {
   }
-};
 
-using CompareTestType = std::array<double, 3>;
-static_assert(CompareEntities<AbsoluteValueComparator<CompareTestType>, CompareTestType>);
+  const auto &statistics = algorithm.statistics();
+  std::cout << "Stagnated after " << algorithm.generation() << " generations, best fitness: " << statistics.bestFitness()
+            << ", mean: " << statistics.mean() << ", diversity: " << statistics.diversity() << "\n";
+}
 
-template <typename TEntity, CompareEntities<TEntity> TComparator> struct SortEntity {
-  static void sort(std::vector<TEntity> &population) { std::sort(population.begin(), population.end(), TComparator::compare); }
-};
+void instrumentedEvolution() {
+  constexpr auto dimension = 4;
+  constexpr auto minInit = 0.;
+  constexpr auto maxInit = 2137.;
+  constexpr auto mutationChance = 0.1;
+  constexpr auto mutationIntensity = 10.;
+  constexpr auto targetLast = 0.001;
+  constexpr auto targetFirst = 0.3;
+  constexpr auto generationLimit = 3;
+  constexpr auto populationSize = 36;
 
-template <typename TSelectionPolicy, typename TEntity>
-concept SelectionPolicy = requires(std::vector<TEntity> &population) {
-  { TSelectionPolicy::select(population) } -> std::same_as<std::pair<TEntity, TEntity>>;
-};
+  using Entity = std::array<double, dimension>;
+  using Comparator = CountingComparator<AbsoluteValueComparator<Entity>>;
 
-template <typename TEntity> struct RandomSelectionPolicy {
-  static std::pair<TEntity, TEntity> select(const std::vector<TEntity> &population) {
-    typename UniformDistribution<std::size_t>::Generator generator{std::random_device{}()};
-    typename UniformDistribution<std::size_t>::Distribution distribution{0, population.size() - 1};
-    const TEntity &parent1 = population[distribution(generator)];
-    const TEntity &parent2 = population[distribution(generator)];
-    return {parent1, parent2};
+  EvolutionaryAlgorithm<Entity, RandomInitiationPolicy<Entity, minInit, maxInit>,
+                        AbsoluteMutationPolicy<Entity, mutationChance, mutationIntensity>, RandomCrossoverPolicy<Entity>,
+                        RankSelectionPolicy<Entity, targetFirst, targetLast, Comparator>,
+                        MaxGenStopConditionPolicy<Entity, generationLimit>, DefaultGenerator, ArrayOfStructs,
+                        PhaseInstrumentation>
+      algorithm(populationSize);
+  algorithm.instrumentation().observe(CsvTraceSink{std::cout});
+  while (algorithm.advance()) {
   }
-};
+}
 
-template <typename TEntity> struct UniqueRandomSelectionPolicy {
-  static std::pair<TEntity, TEntity> select(const std::vector<TEntity> &population) {
-    typename UniformDistribution<std::size_t>::Generator generator{std::random_device{}()};
-    typename UniformDistribution<std::size_t>::Distribution distribution{0, population.size() - 1};
-    // const TEntity &parent1 = population[distribution(generator)];
-    const size_t parent1Index = distribution(generator);
-    size_t parent2Index = parent1Index;
-    while ((parent2Index = distribution(generator)) == parent1Index) {
-    };
-    return {population[parent1Index], population[parent2Index]};
+template <typename TAlgorithm> bool samePopulation(const TAlgorithm &first, const TAlgorithm &second) {
+  if (first.generation() != second.generation() || first.population().size() != second.population().size()) {
+    return false;
   }
-};
-
-template <typename TEntity, double TFIRST, double TLAST, CompareEntities<TEntity> TComparator> struct TargetSelectionPolicy {
-  static std::pair<TEntity, TEntity> select(std::vector<TEntity> &population) {
-    assert(TFIRST >= 0 && TLAST >= 0 && TFIRST >= TLAST);
-    assert(population.size() > 1);
-
-    SortEntity<TEntity, TComparator>::sort(population);
-
-    const double step = (TFIRST - TLAST) / (population.size() - 1);
-    const double sumOfWeights = (TFIRST + TLAST) * population.size() / 2;
-    typename UniformDistribution<double>::Generator generator{std::random_device{}()};
-    typename UniformDistribution<double>::Distribution distribution{0, 1};
-
-    double parent1Random = distribution(generator);
-    double parent1Chance = TLAST / sumOfWeights;
-    size_t parent1Index = 0;
-    while (parent1Random > parent1Chance) {
-      parent1Index++;
-      parent1Chance += step * static_cast<double>(parent1Index);
-    }
-
-    double parent2Random = distribution(generator);
-    double parent2Chance = TLAST / sumOfWeights;
-    size_t parent2Index = 0;
-    while (parent2Random > parent2Chance) {
-      parent2Index++;
-      parent2Chance += step * static_cast<double>(parent2Index);
+  for (std::size_t i = 0; i < first.population().size(); ++i) {
+    if (first.population()[i] != second.population()[i]) {
+      return false;
     }
-
-    return {population[parent1Index], population[parent2Index]};
   }
-};
-
-static_assert(SelectionPolicy<RandomSelectionPolicy<double>, double>);
-static_assert(SelectionPolicy<UniqueRandomSelectionPolicy<double>, double>);
-constexpr double TEST_FIRST = 10;
-constexpr double TEST_LAST = 1;
-static_assert(SelectionPolicy<TargetSelectionPolicy<double, TEST_FIRST, TEST_LAST, AbsoluteValueComparator<double>>, double>);
-/* #endregion */
+  return true;
+}
 
-/* #region StopConditionPolicy */
-template <typename TEntity, typename = void> struct EntityAverage;
+void checkpointEvolution() {
+  constexpr auto dimension = 4;
+  constexpr auto minInit = 0.;
+  constexpr auto maxInit = 2137.;
+  constexpr auto mutationChance = 0.1;
+  constexpr auto mutationIntensity = 10.;
+  constexpr auto targetLast = 0.001;
+  constexpr auto targetFirst = 0.3;
+  constexpr auto stableLimit = 10.;
+  constexpr auto populationSize = 36;
+  constexpr auto checkpointGeneration = 3;
+  constexpr auto threadCount = 2;
+  constexpr std::uint64_t seed = 2137;
 
-template <typename TEntity> struct EntityAverage<TEntity, std::enable_if_t<std::is_arithmetic_v<TEntity>>> {
-  static inline NumeralType_t<TEntity> average(const std::vector<TEntity> &population) {
-    return std::accumulate(population.begin(), population.end(), 0) / population.size();
+  using Entity = std::array<double, dimension>;
+  using Algorithm =
+      EvolutionaryAlgorithm<Entity, RandomInitiationPolicy<Entity, minInit, maxInit>,
+                            BatchAbsoluteMutationPolicy<Entity, mutationChance, mutationIntensity>,
+                            RandomCrossoverPolicy<Entity>,
+                            RankSelectionPolicy<Entity, targetFirst, targetLast, AbsoluteValueComparator<Entity>>,
+                            StableAvgStopConditionPolicy<Entity, stableLimit>, DefaultGenerator, StructOfArrays>;
+
+  ThreadPool pool(threadCount);
+  Algorithm uninterrupted(populationSize, seed);
+  while (uninterrupted.advance(pool)) {
   }
-};
 
-template <typename TEntity> struct EntityAverage<TEntity, std::enable_if_t<!std::is_arithmetic_v<TEntity>>> {
-  static inline NumeralType_t<TEntity> average(const std::vector<TEntity> &population) {
-    NumeralType_t<TEntity> avg{};
-    for (const auto &individual : population) {
-      for (const auto &value : individual) {
-        avg += value;
-      }
-    }
-    avg /= population.size();
-    return avg;
+  const auto path = std::filesystem::temp_directory_path() / "evolution.ckpt";
+  Algorithm interrupted(populationSize, seed);
+  while (interrupted.generation() < checkpointGeneration && interrupted.advance(pool)) {
   }
-};
-
-template <typename TStopConditionPolicy, typename TNumeral>
-concept StopConditionPolicy =
-    requires(TStopConditionPolicy stopConditionPolicy, std::vector<TNumeral> &population, int generation) {
-      { stopConditionPolicy.shouldStop(population, generation) } -> std::same_as<bool>;
-    };
+  interrupted.checkpoint(path);
 
-template <typename TEntity, uint TPARAM> struct MaxGenStopConditionPolicy {
-  bool shouldStop(const std::vector<TEntity> & /*population*/, int generation) { return generation >= TPARAM; }
-};
-
-template <typename TEntity, NumeralType_t<TEntity> TPARAM> struct StableAvgStopConditionPolicy {
-  bool shouldStop(const std::vector<TEntity> &population, int /*generation*/) {
-    NumeralType_t<TEntity> avg = EntityAverage<TEntity>::average(population);
-    if (firstCheck) {
-      lastAvg = avg;
-      firstCheck = false;
-      return false;
-    }
-    if (std::abs(avg - lastAvg) > TPARAM) {
-      lastAvg = avg;
-      return false;
-    }
-    return true;
+  Algorithm resumed(path);
+  while (resumed.advance(pool)) {
   }
+  std::filesystem::remove(path);
+  std::cout << "Resumed from generation " << checkpointGeneration << ", finished at " << resumed.generation() << ", "
+            << (samePopulation(uninterrupted, resumed) ? "same as" : "differs from") << " uninterrupted run\n";
+}
 
-private:
-  NumeralType_t<TEntity> lastAvg{};
-  bool firstCheck = true;
-};
+void traceEvolution() {
+  constexpr auto dimension = 16;
+  constexpr auto minInit = 0.;
+  constexpr auto maxInit = 2137.;
+  constexpr auto mutationChance = 0.1;
+  constexpr auto mutationIntensity = 10.;
+  constexpr auto generationLimit = 50;
+  constexpr auto populationSize = 1000;
 
-constexpr int TEST_PARAM = 10;
-static_assert(StopConditionPolicy<MaxGenStopConditionPolicy<double, TEST_PARAM>, double>);
-static_assert(StopConditionPolicy<StableAvgStopConditionPolicy<double, static_cast<double>(TEST_PARAM)>, double>);
-/* #endregion */
+  using Entity = std::array<double, dimension>;
 
-/* #region EvolutionaryAlgorithm */
+  EvolutionaryAlgorithm<Entity, RandomInitiationPolicy<Entity, minInit, maxInit>,
+                        AbsoluteMutationPolicy<Entity, mutationChance, mutationIntensity>, RandomCrossoverPolicy<Entity>,
+                        RandomSelectionPolicy<Entity>, MaxGenStopConditionPolicy<Entity, generationLimit>,
+                        DefaultGenerator, StructOfArrays>
+      algorithm(populationSize);
 
-template <typename TEntity, InitiationPolicy<TEntity> TInitiationPolicy, MutationPolicy<TEntity> TMutationPolicy,
-          CrossoverPolicy<TEntity> TCrossoverPolicy, SelectionPolicy<TEntity> TSelectionPolicy,
-          StopConditionPolicy<TEntity> TStopConditionPolicy>
-class EvolutionaryAlgorithm {
-public:
-  explicit EvolutionaryAlgorithm(int populationSize) : populationSize_(populationSize) {
-    TInitiationPolicy::init(population_, populationSize);
+  const auto csvPath = std::filesystem::temp_directory_path() / "evolution-trace.csv";
+  const auto binaryPath = std::filesystem::temp_directory_path() / "evolution-trace.bin";
+  std::ofstream csvFile(csvPath);
+  std::ofstream binaryFile(binaryPath, std::ios::binary);
+  std::size_t written = 0;
+  std::size_t dropped = 0;
+  {
+    TraceWriter<Entity> csv(csvFile);
+    TraceWriter<Entity, BinaryTraceFormat> binary(binaryFile);
+    while (algorithm.advance()) {
+      csv.trySnapshot(algorithm.generation(), algorithm.population());
+      binary.trySnapshot(algorithm.generation(), algorithm.population());
+    }
+    // The final population is always written.
+    csv.snapshot(algorithm.generation(), algorithm.population());
+    csv.flush();
+    written = csv.written();
+    dropped = csv.dropped();
   }
 
-  void run() {
-    int generation = 0;
-    while (!stopConditionPolicy_.shouldStop(population_, generation)) {
-      std::vector<TEntity> newPopulation;
+  std::cout << "Traced " << written << " generations (" << dropped << " dropped), CSV: " << std::filesystem::file_size(csvPath)
+            << " B, binary: " << std::filesystem::file_size(binaryPath) << " B\n";
+  std::filesystem::remove(csvPath);
+  std::filesystem::remove(binaryPath);
+}
 
-      for (int i = 0; i < populationSize_; ++i) {
-        auto [parent1, parent2] = TSelectionPolicy::select(population_);
-        TEntity offspring = TCrossoverPolicy::crossover(parent1, parent2);
-        newPopulation.push_back(offspring);
-      }
+void runtimeDimensionEvolution() {
+  constexpr auto minInit = 0.;
+  constexpr auto maxInit = 2137.;
+  constexpr auto mutationChance = 0.1;
+  constexpr auto mutationIntensity = 10.;
+  constexpr auto targetLast = 0.001;
+  constexpr auto targetFirst = 0.3;
+  constexpr auto stableLimit = 10.;
+  constexpr auto populationSize = 1000;
+  constexpr auto warmUpGenerations = 1;
+  constexpr auto threadCount = 2;
+
+  using Entity = std::span<double>;
+  using Algorithm =
+      EvolutionaryAlgorithm<Entity, RandomInitiationPolicy<Entity, minInit, maxInit>,
+                            BatchAbsoluteMutationPolicy<Entity, mutationChance, mutationIntensity>,
+                            RandomCrossoverPolicy<Entity>,
+                            RankSelectionPolicy<Entity, targetFirst, targetLast, AbsoluteValueComparator<Entity>>,
+                            StableAvgStopConditionPolicy<Entity, stableLimit>, DefaultGenerator, FlatArena>;
+
+  // The same instantiation serves every dimension, e.g. one read from a problem file.
+  ThreadPool pool(threadCount);
+  for (const std::size_t dimension : {3, 17}) {
+    Algorithm algorithm(populationSize, dimension);
+    for (int i = 0; i < warmUpGenerations && algorithm.advance(pool); ++i) {
+    }
 
-      population_ = newPopulation;
-      TMutationPolicy::mutate(population_);
-      generation++;
+    const std::size_t allocationsBefore = allocationCount.load();
+    while (algorithm.advance(pool)) {
     }
+    const std::size_t steadyStateAllocations = allocationCount.load() - allocationsBefore;
 
-    std::cout << "Algorithm stopped after " << generation << " generations.\n";
-    printPopulation();
+    std::cout << "Dimension " << algorithm.dimension() << " stopped after " << algorithm.generation()
+              << " generations, heap allocations after warm-up: " << steadyStateAllocations << "\n";
+    assert(steadyStateAllocations == 0);
   }
+}
 
-private:
-  std::vector<TEntity> population_;
-  int populationSize_;
-  TStopConditionPolicy stopConditionPolicy_{};
+// Negated squared distance from a target point; stands in for an expensive simulation.
+template <typename TEntity> struct SphereFitness {
+  static constexpr double target = 100.;
 
-  void printPopulation() const {
-    for (const auto &individual : population_) {
-      PrintEntity<TEntity>::print(individual);
+  [[nodiscard]] double evaluate(const TEntity &entity) const {
+    double distance = 0;
+    for (const double gene : entity) {
+      distance += (gene - target) * (gene - target);
     }
-    std::cout << "\n";
+    return -distance;
   }
 };
-/* #endregion */
 
-/* #region TestMethods */
-void doubleEvolution() {
+void fitnessEvolution() {
+  constexpr auto dimension = 8;
   constexpr auto minInit = 0.;
   constexpr auto maxInit = 2137.;
-  constexpr auto mutationChance = 0.1;
+  constexpr auto geneMutationRate = 0.01;
   constexpr auto mutationIntensity = 10.;
-  constexpr auto crossoverWeight = 0.3;
-  constexpr auto generationLimit = 10;
-  constexpr auto populationSize = 36;
+  constexpr auto targetLast = 0.001;
+  constexpr auto targetFirst = 0.3;
+  constexpr auto stagnationLimit = 10;
+  constexpr auto populationSize = 200;
+  constexpr auto threadCount = 2;
 
-  using Entity = double;
+  using Entity = std::array<double, dimension>;
 
+  // The fitness scores rank the population for selection and decide when to stop; the comparator is not used.
   EvolutionaryAlgorithm<Entity, RandomInitiationPolicy<Entity, minInit, maxInit>,
-                        PercentageMutationPolicy<Entity, mutationChance, mutationIntensity>,
-                        AverageCrossoverPolicy<Entity, crossoverWeight>, RandomSelectionPolicy<Entity>,
-                        MaxGenStopConditionPolicy<Entity, generationLimit>>
+                        GeneAbsoluteMutationPolicy<Entity, geneMutationRate, mutationIntensity>,
+                        RandomCrossoverPolicy<Entity>,
+                        RankSelectionPolicy<Entity, targetFirst, targetLast, AbsoluteValueComparator<Entity>>,
+                        FitnessStagnationStopConditionPolicy<Entity, stagnationLimit>, DefaultGenerator, ArrayOfStructs,
+                        NoInstrumentation, SphereFitness<Entity>>
       algorithm(populationSize);
-  algorithm.run();
+  ThreadPool pool(threadCount);
+  while (algorithm.advance(pool)) {
+  }
+
+  std::cout << "Fitness stagnated after " << algorithm.generation() << " generations, best: " << algorithm.scores().best()
+            << ", evaluations: " << algorithm.evaluation().evaluations()
+            << ", cache hits: " << algorithm.evaluation().cacheHits() << "\n";
 }
 
-void vectorDoubleEvolution() {
+template <typename TEntity, typename TSelectionPolicy> double bestAfterGenerations(ThreadPool &pool) {
+  constexpr auto minInit = 0.;
+  constexpr auto maxInit = 2137.;
+  constexpr auto geneMutationRate = 0.01;
+  constexpr auto mutationIntensity = 10.;
+  constexpr auto maxGenerations = 50;
+  constexpr auto populationSize = 1000;
+
+  EvolutionaryAlgorithm<TEntity, RandomInitiationPolicy<TEntity, minInit, maxInit>,
+                        GeneAbsoluteMutationPolicy<TEntity, geneMutationRate, mutationIntensity>,
+                        RandomCrossoverPolicy<TEntity>, TSelectionPolicy, MaxGenStopConditionPolicy<TEntity, maxGenerations>,
+                        DefaultGenerator, StructOfArrays>
+      algorithm(populationSize);
+  while (algorithm.advance(pool)) {
+  }
+
+  double best = 0;
+  for (std::size_t i = 0; i < algorithm.population().size(); ++i) {
+    best = std::max(best, AbsoluteValueComparator<TEntity>::key(algorithm.population()[i]));
+  }
+  return best;
+}
+
+void batchSelectionEvolution() {
+  constexpr auto dimension = 8;
+  constexpr auto tournamentSize = 3;
+  constexpr auto threadCount = 2;
+
+  using Entity = std::array<double, dimension>;
+  using Comparator = AbsoluteValueComparator<Entity>;
+
+  // Both policies draw all parent pairs of a generation in one O(n) call, without sorting the population.
+  ThreadPool pool(threadCount);
+  const double tournamentBest =
+      bestAfterGenerations<Entity, TournamentSelectionPolicy<Entity, tournamentSize, Comparator>>(pool);
+  const double samplingBest = bestAfterGenerations<Entity, StochasticUniversalSamplingPolicy<Entity, Comparator>>(pool);
+  std::cout << "Best with tournament selection: " << tournamentBest
+            << ", with stochastic universal sampling: " << samplingBest << "\n";
+}
+
+void outOfCoreEvolution() {
   constexpr auto dimension = 4;
   constexpr auto minInit = 0.;
   constexpr auto maxInit = 2137.;
   constexpr auto mutationChance = 0.1;
   constexpr auto mutationIntensity = 10.;
-  constexpr auto targetLast = 0.001;
-  constexpr auto targetFirst = 0.3;
-  constexpr auto generationLimit = 10.;
-  constexpr auto populationSize = 36;
+  constexpr auto maxGenerations = 3;
+  constexpr std::size_t populationSize = 1'000'000;
 
   using Entity = std::array<double, dimension>;
 
-  EvolutionaryAlgorithm<Entity, LinSpaceInitiationPolicy<Entity, minInit, maxInit>,
+  // Both generations live in unlinked files under $TMPDIR, so populationSize is bounded by disk rather than RAM.
+  EvolutionaryAlgorithm<Entity, RandomInitiationPolicy<Entity, minInit, maxInit>,
                         AbsoluteMutationPolicy<Entity, mutationChance, mutationIntensity>, RandomCrossoverPolicy<Entity>,
-                        TargetSelectionPolicy<Entity, targetFirst, targetLast, AbsoluteValueComparator<Entity>>,
-                        StableAvgStopConditionPolicy<Entity, generationLimit>>
+                        RandomSelectionPolicy<Entity>, MaxGenStopConditionPolicy<Entity, maxGenerations>,
+                        DefaultGenerator, MappedFiles>
       algorithm(populationSize);
-  algorithm.run();
+  while (algorithm.advance()) {
+  }
+  std::cout << "Mapped population of " << algorithm.population().size() << " stopped after " << algorithm.generation()
+            << " generations\n";
 }
 
-void intEvolution() {
-  constexpr auto minInit = 0;
-  constexpr auto maxInit = 2137;
-  constexpr auto mutationChance = 0.1;
-  constexpr auto mutationIntensity = 10;
-  constexpr auto crossoverWeight = 0.3;
-  constexpr auto generationLimit = 10;
-  constexpr auto populationSize = 36;
+// Ranks entities by their distance to SphereFitness's optimum, so the best key converges to 0 from below.
+template <typename TEntity> struct SphereComparator {
+  static double key(const TEntity &entity) { return SphereFitness<TEntity>{}.evaluate(entity); }
+};
 
-  using Entity = int;
+void hyperparameterSweep() {
+  constexpr auto dimension = 4;
+  constexpr auto minInit = 0.;
+  constexpr auto maxInit = 2137.;
+  constexpr auto generationLimit = 200;
+  constexpr auto target = -1e5;
+  constexpr auto threadCount = 4;
 
-  EvolutionaryAlgorithm<Entity, RandomInitiationPolicy<Entity, minInit, maxInit>,
-                        AbsoluteMutationPolicy<Entity, mutationChance, mutationIntensity>,
-                        AverageCrossoverPolicy<Entity, crossoverWeight>, UniqueRandomSelectionPolicy<Entity>,
-                        StableAvgStopConditionPolicy<Entity, generationLimit>>
-      algorithm(populationSize);
-  algorithm.run();
+  using Entity = std::array<double, dimension>;
+  using Comparator = SphereComparator<Entity>;
+  using Algorithm =
+      EvolutionaryAlgorithm<Entity, RandomInitiationPolicy<Entity, minInit, maxInit>, RuntimeAbsoluteMutationPolicy<Entity>,
+                            RuntimeAverageCrossoverPolicy<Entity>, RuntimeRankSelectionPolicy<Entity, Comparator>,
+                            MaxGenStopConditionPolicy<Entity, generationLimit>>;
+
+  // Every configuration of the grid is evolved independently; the runs share a work-stealing pool.
+  SweepGrid grid;
+  grid.populationSizes = {50, 200};
+  grid.mutationChances = {0.1, 0.5};
+  grid.mutationIntensities = {10., 100.};
+  grid.crossoverWeights = {0.3, 0.5};
+  grid.targets = {{0.3, 0.001}, {1., 0.5}};
+  SweepOptions options;
+  options.target = target;
+
+  HyperparameterSweep<Algorithm, Comparator> sweep(grid.configurations(), options);
+  WorkStealingPool pool(threadCount);
+  const SweepResults &results = sweep.run(pool);
+
+  // results.writeTable() and results.writeCurves() give the full table; only the fastest configuration is shown here.
+  const SweepRun *fastest = nullptr;
+  std::size_t reached = 0;
+  for (const SweepRun &run : results.runs) {
+    if (run.generationsToTarget >= 0) {
+      ++reached;
+      if (fastest == nullptr || run.generationsToTarget < fastest->generationsToTarget) {
+        fastest = &run;
+      }
+    }
+  }
+  std::cout << "Sweep: " << reached << " of " << results.runs.size() << " runs reached the target";
+  if (fastest != nullptr) {
+    const SweepConfiguration &configuration = results.configurations[fastest->configuration];
+    std::cout << ", fastest in " << fastest->generationsToTarget << " generations with population "
+              << configuration.populationSize << ", mutation " << configuration.parameters.mutationChance << "/"
+              << configuration.parameters.mutationIntensity << ", crossover " << configuration.parameters.crossoverWeight
+              << ", target " << configuration.parameters.targetFirst << "-" << configuration.parameters.targetLast;
+  }
+  std::cout << "\n";
 }
 
-void vectorIntEvolution() {
+template <typename TEntity, typename TReplacementPolicy> double bestAfterReplacement() {
+  constexpr auto minInit = 0.;
+  constexpr auto maxInit = 2137.;
+  constexpr auto mutationChance = 0.5;
+  constexpr auto mutationIntensity = 100.;
+  constexpr auto maxGenerations = 100;
+  constexpr auto populationSize = 100;
+  constexpr std::uint64_t seed = 2137;
+
+  EvolutionaryAlgorithm<TEntity, RandomInitiationPolicy<TEntity, minInit, maxInit>,
+                        AbsoluteMutationPolicy<TEntity, mutationChance, mutationIntensity>, RandomCrossoverPolicy<TEntity>,
+                        RandomSelectionPolicy<TEntity>, MaxGenStopConditionPolicy<TEntity, maxGenerations>,
+                        DefaultGenerator, ArrayOfStructs, NoInstrumentation, NoFitnessFunction, TReplacementPolicy>
+      algorithm(populationSize, seed);
+  while (algorithm.advance()) {
+  }
+
+  double best = -std::numeric_limits<double>::infinity();
+  for (const TEntity &individual : algorithm.population()) {
+    best = std::max(best, SphereComparator<TEntity>::key(individual));
+  }
+  return best;
+}
+
+void replacementEvolution() {
   constexpr auto dimension = 4;
-  constexpr auto minInit = 0;
-  constexpr auto maxInit = 2137;
-  constexpr auto mutationChance = 0.1;
-  constexpr auto mutationIntensity = 10;
-  constexpr auto crossoverWeight = 0.3;
-  constexpr auto generationLimit = 10;
-  constexpr auto populationSize = 36;
+  constexpr auto eliteCount = 2;
+  constexpr auto offspringRatio = 3.;
 
-  using Entity = std::array<int, dimension>;
+  using Entity = std::array<double, dimension>;
+  using Comparator = SphereComparator<Entity>;
+
+  // Random parent selection puts no pressure on the population; only the replacement policy decides who survives.
+  std::cout << "Best after generational replacement: "
+            << bestAfterReplacement<Entity, GenerationalReplacementPolicy>() << ", with elitism: "
+            << bestAfterReplacement<Entity, ElitistReplacementPolicy<Entity, eliteCount, Comparator>>()
+            << ", (mu+lambda): "
+            << bestAfterReplacement<Entity, PlusReplacementPolicy<Entity, offspringRatio, Comparator>>()
+            << ", (mu,lambda): "
+            << bestAfterReplacement<Entity, CommaReplacementPolicy<Entity, offspringRatio, Comparator>>() << "\n";
+}
 
+// Wall-clock time until the best individual reaches `target`, averaged over the runs that reached it within
+// `generationLimit` generations. The runs go one after another on a single worker, so their timings do not interfere.
+template <typename TEntity, typename TMutationPolicy>
+void reportTimeToTarget(std::string_view name, double target, int generationLimit) {
+  constexpr auto minInit = 0.;
+  constexpr auto maxInit = 2137.;
+  constexpr auto tournamentSize = 3;
+  constexpr auto eliteCount = 1;
+  constexpr auto populationSize = 100;
+  constexpr auto repetitions = 5;
+
+  using Comparator = SphereComparator<TEntity>;
+  using Algorithm = EvolutionaryAlgorithm<TEntity, RandomInitiationPolicy<TEntity, minInit, maxInit>, TMutationPolicy,
+                                          RandomCrossoverPolicy<TEntity>,
+                                          TournamentSelectionPolicy<TEntity, tournamentSize, Comparator>,
+                                          MaxGenStopConditionPolicy<TEntity, std::numeric_limits<int>::max()>,
+                                          DefaultGenerator, ArrayOfStructs, NoInstrumentation, NoFitnessFunction,
+                                          ElitistReplacementPolicy<TEntity, eliteCount, Comparator>>;
+
+  SweepOptions options;
+  options.repetitions = repetitions;
+  options.maxGenerations = generationLimit;
+  options.target = target;
+  options.stopAtTarget = true;
+  HyperparameterSweep<Algorithm, Comparator> sweep({SweepConfiguration{populationSize, EvolutionParameters{}}}, options);
+  WorkStealingPool pool(1);
+  const SweepResults &results = sweep.run(pool);
+
+  std::size_t reached = 0;
+  double seconds = 0;
+  double generations = 0;
+  double best = -std::numeric_limits<double>::infinity();
+  for (const SweepRun &run : results.runs) {
+    best = std::max(best, run.curve.back());
+    if (run.generationsToTarget >= 0) {
+      ++reached;
+      seconds += run.secondsToTarget;
+      generations += run.generationsToTarget;
+    }
+  }
+  std::cout << name << ": " << reached << " of " << results.runs.size() << " runs reached the target";
+  if (reached > 0) {
+    std::cout << ", on average in " << generations / static_cast<double>(reached) << " generations and "
+              << seconds / static_cast<double>(reached) * 1e3 << " ms";
+  } else {
+    std::cout << ", best " << best << " after " << generationLimit << " generations";
+  }
+  std::cout << "\n";
+}
+
+void adaptiveMutationBenchmark() {
+  constexpr auto dimension = 8;
+  constexpr auto mutationChance = 1.;
+  constexpr auto smallIntensity = 1.;
+  constexpr auto largeIntensity = 100.;
+  constexpr auto target = -1e-6;
+  constexpr auto generationLimit = 5000;
+
+  using Entity = std::array<double, dimension>;
+  using AdaptiveEntity = SelfAdaptiveGenome<double, dimension, largeIntensity>;
+  using Comparator = SphereComparator<Entity>;
+
+  // Every child is mutated, so a fixed intensity keeps the whole population as spread out as its steps; the adaptive
+  // policies start as coarse as the large one and narrow their steps as the population converges on the optimum.
+  reportTimeToTarget<Entity, AbsoluteMutationPolicy<Entity, mutationChance, smallIntensity>>("Fixed intensity 1", target,
+                                                                                            generationLimit);
+  reportTimeToTarget<Entity, AbsoluteMutationPolicy<Entity, mutationChance, largeIntensity>>("Fixed intensity 100",
+                                                                                              target, generationLimit);
+  reportTimeToTarget<Entity, OneFifthSuccessMutationPolicy<Entity, mutationChance, largeIntensity, Comparator>>(
+      "1/5th success rule", target, generationLimit);
+  reportTimeToTarget<AdaptiveEntity, SelfAdaptiveMutationPolicy<AdaptiveEntity, mutationChance>>("Self-adaptive sigma",
+                                                                                                 target, generationLimit);
+}
+
+template <typename TNumeral> void compactGenomeRun(std::string_view name) {
+  constexpr TNumeral minInit{0};
+  constexpr TNumeral maxInit{2137};
+  constexpr TNumeral mutationIntensity{10};
+  constexpr auto mutationChance = 0.1;
+  constexpr auto dimension = 64;
+  constexpr auto tournamentSize = 3;
+  constexpr auto generationLimit = 5;
+  constexpr auto populationSize = 200000;
+  constexpr std::uint64_t seed = 2137;
+
+  using Entity = std::array<TNumeral, dimension>;
+  using Comparator = SphereComparator<Entity>;
   EvolutionaryAlgorithm<Entity, RandomInitiationPolicy<Entity, minInit, maxInit>,
-                        PercentageMutationPolicy<Entity, mutationChance, mutationIntensity>, RandomCrossoverPolicy<Entity>,
-                        UniqueRandomSelectionPolicy<Entity>, MaxGenStopConditionPolicy<Entity, generationLimit>>
-      algorithm(populationSize);
-  algorithm.run();
+                        AbsoluteMutationPolicy<Entity, mutationChance, mutationIntensity>, RandomCrossoverPolicy<Entity>,
+                        TournamentSelectionPolicy<Entity, tournamentSize, Comparator>,
+                        MaxGenStopConditionPolicy<Entity, generationLimit>>
+      algorithm(populationSize, seed);
+
+  const auto start = std::chrono::steady_clock::now();
+  while (algorithm.advance()) {
+  }
+  const double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+  double best = -std::numeric_limits<double>::infinity();
+  for (const Entity &individual : algorithm.population()) {
+    best = std::max(best, Comparator::key(individual));
+  }
+  std::cout << name << " genes: " << populationSize * sizeof(Entity) / 1024 << " KiB per population, "
+            << milliseconds / generationLimit << " ms per generation, best " << best << "\n";
 }
 
-/* #endregion */
+void compactGenomeEvolution() {
+  // The same problem with genes stored in 8, 4 and 2 bytes; every kernel computes in double or float and narrows on store.
+  compactGenomeRun<double>("double");
+  compactGenomeRun<float>("float");
+  compactGenomeRun<BFloat16>("bfloat16");
+  compactGenomeRun<std::int16_t>("int16");
+}
 
 int main() {
   doubleEvolution();
   vectorDoubleEvolution();
   intEvolution();
   vectorIntEvolution();
+  parallelVectorDoubleEvolution();
+  seededEvolution();
+  allocationFreeEvolution();
+  structOfArraysEvolution();
+  batchMutationEvolution();
+  geneMutationEvolution();
+  islandEvolution();
+  steadyStateEvolution();
+  statisticsEvolution();
+  instrumentedEvolution();
+  checkpointEvolution();
+  traceEvolution();
+  runtimeDimensionEvolution();
+  fitnessEvolution();
+  batchSelectionEvolution();
+  outOfCoreEvolution();
+  hyperparameterSweep();
+  replacementEvolution();
+  adaptiveMutationBenchmark();
+  compactGenomeEvolution();
 
   return 0;
 }